@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+SimpleStringPluginAudioProcessorEditor::SimpleStringPluginAudioProcessorEditor (SimpleStringPluginAudioProcessor& p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+      keyboardComponent (p.getKeyboardState(), MidiKeyboardComponent::horizontalKeyboard)
+{
+    // name the notes with middle C as C4, like the README
+    keyboardComponent.setOctaveForMiddleC (4);
+    addAndMakeVisible (keyboardComponent);
+
+    setSize (800, 200);
+
+    startTimerHz (15); // start the timer (15 Hz is a nice tradeoff between CPU usage and update speed)
+}
+
+SimpleStringPluginAudioProcessorEditor::~SimpleStringPluginAudioProcessorEditor()
+{
+    // Stop the graphics update
+    stopTimer();
+}
+
+//==============================================================================
+void SimpleStringPluginAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    // clear the background
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+
+    g.setColour (Colours::cyan);
+    g.setFont (15.0f);
+
+    String info = "Active voices: " + String (audioProcessor.getNumActiveVoices())
+                + "    Callback load: " + String (audioProcessor.getCallbackLoad() * 100.0, 1) + " %";
+
+    if (highestNote >= 0)
+        info = "Playable notes: " + MidiMessage::getMidiNoteName (audioProcessor.getLowestNote(), true, true, 4)
+             + " - " + MidiMessage::getMidiNoteName (highestNote, true, true, 4) + "    " + info;
+
+    g.drawFittedText (info, getLocalBounds().removeFromTop (getHeight() - keyboardComponent.getHeight()),
+                      juce::Justification::centred, 1);
+}
+
+void SimpleStringPluginAudioProcessorEditor::resized()
+{
+    keyboardComponent.setBounds (getLocalBounds().removeFromBottom (120));
+}
+
+void SimpleStringPluginAudioProcessorEditor::timerCallback()
+{
+    // The playable range depends on the sample rate, so it is only known after prepareToPlay()
+    if (audioProcessor.getHighestNote() != highestNote && audioProcessor.getHighestNote() >= 0)
+    {
+        highestNote = audioProcessor.getHighestNote();
+        keyboardComponent.setAvailableRange (audioProcessor.getLowestNote(), highestNote);
+    }
+
+    repaint(); // update the display X times a second
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+    On-screen keyboard to play the strings (limited to the notes that have a string) and a display
+    of the playable range, the number of voices and the callback load.
+*/
+class SimpleStringPluginAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                                public Timer // for graphics refresh
+{
+public:
+    SimpleStringPluginAudioProcessorEditor (SimpleStringPluginAudioProcessor&);
+    ~SimpleStringPluginAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    void timerCallback() override;
+
+private:
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    SimpleStringPluginAudioProcessor& audioProcessor;
+
+    MidiKeyboardComponent keyboardComponent;
+
+    // highest note that the keyboard currently shows as playable
+    int highestNote = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleStringPluginAudioProcessorEditor)
+};
@@ -0,0 +1,562 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+SimpleStringPluginAudioProcessor::SimpleStringPluginAudioProcessor()
+     : AudioProcessor (BusesProperties().withOutput ("Output", juce::AudioChannelSet::stereo(), true))
+{
+}
+
+SimpleStringPluginAudioProcessor::~SimpleStringPluginAudioProcessor()
+{
+}
+
+//==============================================================================
+const juce::String SimpleStringPluginAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SimpleStringPluginAudioProcessor::acceptsMidi() const
+{
+    return true;
+}
+
+bool SimpleStringPluginAudioProcessor::producesMidi() const
+{
+    return false;
+}
+
+bool SimpleStringPluginAudioProcessor::isMidiEffect() const
+{
+    return false;
+}
+
+double SimpleStringPluginAudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int SimpleStringPluginAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int SimpleStringPluginAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SimpleStringPluginAudioProcessor::setCurrentProgram (int index)
+{
+    juce::ignoreUnused (index);
+}
+
+const juce::String SimpleStringPluginAudioProcessor::getProgramName (int index)
+{
+    juce::ignoreUnused (index);
+    return {};
+}
+
+void SimpleStringPluginAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+    juce::ignoreUnused (index, newName);
+}
+
+//==============================================================================
+NamedValueSet SimpleStringPluginAudioProcessor::getStringParameters (double frequency)
+{
+    NamedValueSet parameters;
+
+    // parameters you'll use to initialise more than one other parameter should be defined here
+    double r = 0.0005;
+    double L = 1;
+    double rho = 7850;
+    double A = r * r * MathConstants<double>::pi;
+
+    // The fundamental frequency of the string is f0 = c / (2L), so the tension follows from cSq = T / (rho * A) = (2 * L * f0)^2
+    double cSq = (2.0 * L * frequency) * (2.0 * L * frequency);
+
+    parameters.set ("L", L);
+    parameters.set ("rho", rho);
+    parameters.set ("A", A);
+    parameters.set ("T", cSq * rho * A);
+    parameters.set ("E", 2e11);
+    parameters.set ("I", r * r * r * r * MathConstants<double>::pi * 0.25);
+    parameters.set ("sigma0", sigma0);
+    parameters.set ("sigma1", 0.005);
+
+    // width (in m) of the area over which the hammer acts on the string
+    parameters.set ("excitationWidth", 0.02);
+
+    // hammer parameters (the strike velocity is set by the MIDI velocity)
+    parameters.set ("MH", 0.005);
+    parameters.set ("KH", 1e8);
+    parameters.set ("alphaH", 2.5);
+    parameters.set ("vH", maxHammerVelocity);
+
+    // bow parameters (not used by the plugin)
+    parameters.set ("a", 100);
+    parameters.set ("maxFb", 5.0);
+
+    return parameters;
+}
+
+void SimpleStringPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    keyboardState.reset();
+
+    blockSize = samplesPerBlock;
+
+    // The strings only need to be recreated if the sample rate has changed
+    if (sampleRate == fs && !strings.empty())
+    {
+        for (int v : activeVoices)
+            stopVoice (v);
+        activeVoices.clear();
+        return;
+    }
+
+    fs = sampleRate;
+
+    strings.clear();
+
+    /*  Create a string for every note from lowestNote upwards. The grid spacing follows from both
+        the wave speed and the stiffness. For low notes the stiffness dominates (note 28 has N = 129
+        at 44.1 kHz), but for high notes the tension term dominates and N is roughly fs / (2 * f0),
+        so these do not have enough grid points left for the scheme and the exciters. Stop at the
+        first note that has less than minN intervals.
+     */
+    int minN = 16;
+    for (int note = lowestNote; note < 128; ++note)
+    {
+        NamedValueSet parameters = getStringParameters (MidiMessage::getMidiNoteInHertz (note));
+        auto string = std::make_unique<SimpleString> (parameters, 1.0 / fs);
+
+        if (string->getNumIntervals() < minN)
+            break;
+
+        strings.push_back (std::move (string));
+    }
+
+    voices = std::vector<Voice> (strings.size());
+    highestNote = lowestNote + static_cast<int> (strings.size()) - 1;
+
+    // Calibrate the strings, and time this to get a first estimate of the time per grid point
+    stringGains.resize (strings.size());
+    referenceEnergies.resize (strings.size());
+
+    double calibrationPoints = 0;
+    auto startTicks = Time::getHighResolutionTicks();
+    for (int i = 0; i < static_cast<int> (strings.size()); ++i)
+        calibrationPoints += calibrateString (i) * static_cast<double> (strings[i]->getNumIntervals());
+
+    timePerPoint = calibrationPoints > 0 ? Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) / calibrationPoints : 0;
+    fixedTime = 0;
+    sumW = sumX = sumY = sumXX = sumXY = 0;
+
+    // Reserve the memory up front so that starting a voice never allocates
+    activeVoices.clear();
+    activeVoices.reserve (strings.size());
+
+    numActiveVoices = 0;
+}
+
+int SimpleStringPluginAudioProcessor::calibrateString (int idx)
+{
+    SimpleString* string = strings[idx].get();
+    string->strike (strikeLoc, maxHammerVelocity);
+
+    // Run the string until the hammer has left it, and at least as long as it takes for the output to peak
+    double peak = 0;
+    int minLength = static_cast<int> (0.05 * fs);
+    int maxLength = static_cast<int> (0.2 * fs);
+    int n = 0;
+    for (; n < maxLength && (n < minLength || string->isExcited()); ++n)
+    {
+        string->calculateScheme();
+        string->updateStates();
+        peak = std::max (peak, std::abs (string->getOutput (outputLoc)));
+    }
+
+    stringGains[idx] = peak > 0 ? 1.0 / peak : 0;
+    referenceEnergies[idx] = std::max (string->getEnergy(), std::numeric_limits<double>::min());
+
+    string->reset();
+
+    return n;
+}
+
+void SimpleStringPluginAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+}
+
+bool SimpleStringPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+    // This is a synth, so only mono or stereo outputs are supported
+    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::mono()
+        || layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
+}
+
+void SimpleStringPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    // Start measuring the time of the callback
+    auto startTicks = Time::getHighResolutionTicks();
+
+    int numSamples = buffer.getNumSamples();
+    buffer.clear();
+
+    // Add the notes played on the on-screen keyboard to the incoming MIDI
+    keyboardState.processNextMidiBuffer (midiMessages, 0, numSamples, true);
+
+    // Hosts may call this without any samples (e.g. to only pass MIDI). Handle the MIDI, but leave
+    // the block size and the load estimate alone as there is no time between callbacks to measure.
+    if (numSamples == 0)
+    {
+        for (const auto metadata : midiMessages)
+            handleMidiMessage (metadata.getMessage());
+
+        numActiveVoices = static_cast<int> (activeVoices.size());
+        return;
+    }
+
+    blockSize = numSamples;
+
+    updateVoices();
+
+    pointsCalculated = 0;
+
+    // Calculate the voices in between the MIDI events so that notes start at their exact sample
+    int curSample = 0;
+    for (const auto metadata : midiMessages)
+    {
+        int eventSample = jlimit (curSample, numSamples, metadata.samplePosition);
+        renderVoices (buffer, curSample, eventSample);
+        handleMidiMessage (metadata.getMessage());
+        curSample = eventSample;
+    }
+    renderVoices (buffer, curSample, numSamples);
+
+    // limiter for your ears (only as a safety net, the voices are scaled to leave headroom) and copy to the other channel(s)
+    float* const channelData = buffer.getWritePointer (0);
+    for (int i = 0; i < numSamples; ++i)
+        channelData[i] = jlimit (-1.0f, 1.0f, channelData[i]);
+
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom (channel, 0, buffer, 0, 0, numSamples);
+
+    //// Measure the callback load ////
+    double elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+    double load = elapsed * fs / numSamples;
+
+    // Displayed load: follow increases right away (the deadline is about the worst case) and decrease slowly
+    double prevLoad = callbackLoad.load();
+    callbackLoad = load > prevLoad ? load : 0.99 * prevLoad + 0.01 * load;
+
+    updateCostEstimate (elapsed, numSamples);
+
+    numActiveVoices = static_cast<int> (activeVoices.size());
+}
+
+//==============================================================================
+void SimpleStringPluginAudioProcessor::handleMidiMessage (const MidiMessage& message)
+{
+    if (message.isNoteOn())
+    {
+        noteOn (message.getNoteNumber(), message.getFloatVelocity());
+    }
+    else if (message.isNoteOff())
+    {
+        noteOff (message.getNoteNumber());
+    }
+    else if (message.isAllSoundOff())
+    {
+        for (int v : activeVoices)
+            stopVoice (v);
+        activeVoices.clear();
+    }
+    else if (message.isAllNotesOff())
+    {
+        for (int v : activeVoices)
+            noteOff (v + lowestNote);
+    }
+}
+
+void SimpleStringPluginAudioProcessor::noteOn (int noteNumber, float velocity)
+{
+    int idx = noteNumber - lowestNote;
+    if (idx < 0 || idx >= static_cast<int> (strings.size()))
+        return;
+
+    Voice& voice = voices[idx];
+
+    // A voice that is fading out is started again as a new voice
+    if (voice.stolen)
+        removeVoice (idx);
+
+    // Make room for the voice (a note that is still sounding is struck again). If that isn't possible the note is dropped.
+    if (!voice.active)
+    {
+        if (!makeRoom (strings[idx]->getNumIntervals(), 0))
+            return;
+
+        voice.active = true;
+        activeVoices.push_back (idx);
+    }
+
+    voice.held = true;
+    voice.stolen = false;
+    voice.gain = 1.0;
+
+    strings[idx]->setDamping (sigma0);
+
+    double hammerVelocity = velocity * maxHammerVelocity;
+    strings[idx]->strike (strikeLoc, hammerVelocity);
+
+    // The string does not have any energy yet, so use the kinetic energy of the hammer (relative to full velocity) until the next block
+    voice.level = velocity * velocity;
+}
+
+void SimpleStringPluginAudioProcessor::noteOff (int noteNumber)
+{
+    int idx = noteNumber - lowestNote;
+    if (idx < 0 || idx >= static_cast<int> (strings.size()) || !voices[idx].active)
+        return;
+
+    // Damp the string, it will be freed once it is silent
+    voices[idx].held = false;
+    strings[idx]->setDamping (dampedSigma0);
+}
+
+//==============================================================================
+void SimpleStringPluginAudioProcessor::updateVoices()
+{
+    // Free the voices that have become silent
+    for (int i = static_cast<int> (activeVoices.size()) - 1; i >= 0; --i)
+    {
+        int v = activeVoices[i];
+
+        // keep the level of the hammer while it is still in contact with the string
+        if (strings[v]->isExcited())
+            continue;
+
+        // The energy that a strike puts into a string differs a lot between notes, so compare it to the energy after a strike at full velocity
+        voices[v].level = strings[v]->getEnergy() / referenceEnergies[v];
+        if (voices[v].level < silenceThreshold)
+        {
+            stopVoice (v);
+            activeVoices.erase (activeVoices.begin() + i);
+        }
+    }
+
+    // If the callback takes too long, steal voices until the estimated load is within the target again (but keep at least one)
+    makeRoom (0, 1);
+}
+
+void SimpleStringPluginAudioProcessor::renderVoices (AudioBuffer<float>& buffer, int startSample, int endSample)
+{
+    if (startSample >= endSample)
+        return;
+
+    float* const channelData = buffer.getWritePointer (0);
+
+    for (int i = static_cast<int> (activeVoices.size()) - 1; i >= 0; --i)
+    {
+        int v = activeVoices[i];
+        SimpleString* string = strings[v].get();
+        Voice& voice = voices[v];
+        double gain = stringGains[v] * voiceGain;
+
+        for (int n = startSample; n < endSample; ++n)
+        {
+            string->calculateScheme();
+            string->updateStates();
+
+            if (voice.stolen)
+                voice.gain = std::max (voice.gain - 1.0 / fadeLength, 0.0);
+
+            channelData[n] += static_cast<float> (voice.gain * gain * string->getOutput (outputLoc));
+        }
+        pointsCalculated += string->getNumIntervals() * (endSample - startSample);
+
+        // free the voice when it is done fading out
+        if (voice.stolen && voice.gain <= 0)
+        {
+            stopVoice (v);
+            activeVoices.erase (activeVoices.begin() + i);
+        }
+    }
+}
+
+bool SimpleStringPluginAudioProcessor::makeRoom (int extraPoints, int numVoicesToKeep)
+{
+    int extraVoices = extraPoints > 0 ? 1 : 0;
+
+    // The voice won't fit even if all other voices are stolen
+    if (extraVoices > maxVoices || (!isNonRealtime() && estimateLoad (extraPoints) > targetLoad))
+        return false;
+
+    // Too many voices: let the quietest fade out
+    while (exceedsVoiceCount (extraVoices))
+        if (!stealVoice (numVoicesToKeep))
+            return false;
+
+    // Too much load: voices that are fading out still need to be calculated, so end them right away
+    while (exceedsLoad (extraPoints))
+        if (!endFadingVoice() && !stealVoice (numVoicesToKeep))
+            return false;
+
+    return true;
+}
+
+bool SimpleStringPluginAudioProcessor::exceedsVoiceCount (int extraVoices)
+{
+    int numVoices = extraVoices;
+    for (int v : activeVoices)
+        if (!voices[v].stolen)
+            ++numVoices;
+
+    return numVoices > maxVoices;
+}
+
+bool SimpleStringPluginAudioProcessor::exceedsLoad (int extraPoints)
+{
+    // Offline rendering has no deadline, so only the voice count matters there
+    if (isNonRealtime())
+        return false;
+
+    int numPoints = extraPoints;
+    for (int v : activeVoices)
+        numPoints += strings[v]->getNumIntervals();
+
+    return estimateLoad (numPoints) > targetLoad;
+}
+
+double SimpleStringPluginAudioProcessor::estimateLoad (int numPoints)
+{
+    // the estimated time of a callback divided by the time between callbacks
+    return (fixedTime + timePerPoint * numPoints * blockSize) * fs / blockSize;
+}
+
+bool SimpleStringPluginAudioProcessor::stealVoice (int numVoicesToKeep)
+{
+    int quietestIdx = -1;
+    int numStolen = 0;
+    for (int v : activeVoices)
+    {
+        if (voices[v].stolen)
+        {
+            ++numStolen;
+            continue;
+        }
+        if (quietestIdx == -1 || voices[v].level < voices[quietestIdx].level)
+            quietestIdx = v;
+    }
+
+    if (quietestIdx == -1 || static_cast<int> (activeVoices.size()) - numStolen <= numVoicesToKeep)
+        return false;
+
+    // Limit the number of voices that are fading out
+    if (numStolen >= maxStolenVoices)
+        endFadingVoice();
+
+    voices[quietestIdx].stolen = true;
+    return true;
+}
+
+bool SimpleStringPluginAudioProcessor::endFadingVoice()
+{
+    int fadedIdx = -1;
+    for (int v : activeVoices)
+        if (voices[v].stolen && (fadedIdx == -1 || voices[v].gain < voices[fadedIdx].gain))
+            fadedIdx = v;
+
+    if (fadedIdx == -1)
+        return false;
+
+    removeVoice (fadedIdx);
+    return true;
+}
+
+void SimpleStringPluginAudioProcessor::removeVoice (int idx)
+{
+    stopVoice (idx);
+    activeVoices.erase (std::find (activeVoices.begin(), activeVoices.end(), idx));
+}
+
+void SimpleStringPluginAudioProcessor::updateCostEstimate (double elapsed, int numSamples)
+{
+    // A callback that got preempted says nothing about the cost of the voices, so limit how much a single callback can count
+    double predicted = fixedTime + timePerPoint * pointsCalculated;
+    elapsed = std::min (elapsed, 2.0 * predicted + 0.1 * numSamples / fs);
+
+    // Forget older callbacks with a time constant of costTimeConstant seconds
+    double decay = exp (-numSamples / (costTimeConstant * fs));
+    sumW = decay * sumW + 1.0;
+    sumX = decay * sumX + pointsCalculated;
+    sumY = decay * sumY + elapsed;
+    sumXX = decay * sumXX + pointsCalculated * pointsCalculated;
+    sumXY = decay * sumXY + pointsCalculated * elapsed;
+
+    // The time per grid point can only be fitted if the number of points varies enough, otherwise keep the previous one
+    double varX = sumW * sumXX - sumX * sumX;
+    if (varX > 0.01 * sumX * sumX)
+    {
+        double slope = (sumW * sumXY - sumX * sumY) / varX;
+        if (slope > 0)
+            timePerPoint = slope;
+    }
+
+    fixedTime = std::max ((sumY - timePerPoint * sumX) / sumW, 0.0);
+}
+
+void SimpleStringPluginAudioProcessor::stopVoice (int idx)
+{
+    // Note that this does not remove the voice from activeVoices
+    voices[idx] = Voice();
+    strings[idx]->reset();
+    strings[idx]->setDamping (sigma0);
+}
+
+//==============================================================================
+bool SimpleStringPluginAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleStringPluginAudioProcessor::createEditor()
+{
+    return new SimpleStringPluginAudioProcessorEditor (*this);
+}
+
+//==============================================================================
+void SimpleStringPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // There are no parameters (yet) to store
+    juce::ignoreUnused (destData);
+}
+
+void SimpleStringPluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    juce::ignoreUnused (data, sizeInBytes);
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SimpleStringPluginAudioProcessor();
+}
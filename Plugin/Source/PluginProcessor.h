@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/SimpleString.h"
+
+//==============================================================================
+/*
+    Polyphonic string synthesiser. Every MIDI note has its own string (with the tension
+    following from the pitch of the note) that is struck by its hammer on a note-on.
+    The strings that are currently sounding are the voices.
+*/
+class SimpleStringPluginAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    //==============================================================================
+    SimpleStringPluginAudioProcessor();
+    ~SimpleStringPluginAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    //==============================================================================
+    MidiKeyboardState& getKeyboardState() { return keyboardState; };
+
+    // for displaying in the editor
+    int getNumActiveVoices() { return numActiveVoices.load(); };
+
+    // range of notes that have a string (highest is -1 before prepareToPlay() has been called)
+    int getLowestNote() { return lowestNote; };
+    int getHighestNote() { return highestNote.load(); };
+    double getCallbackLoad() { return callbackLoad.load(); };
+
+private:
+    //==============================================================================
+    struct Voice
+    {
+        bool active = false;
+        bool held = false;      // whether the note is still held down
+        bool stolen = false;    // whether the voice is fading out after being stolen
+        double gain = 1.0;
+        double level = 0.0;     // energy of the string relative to a strike at full velocity (used for voice stealing)
+    };
+
+    // parameter set for a string with a given fundamental frequency
+    NamedValueSet getStringParameters (double frequency);
+
+    // strike a string at full velocity to find its output gain and reference energy. Returns the number of samples that were calculated.
+    int calibrateString (int idx);
+
+    void handleMidiMessage (const MidiMessage& message);
+    void noteOn (int noteNumber, float velocity);
+    void noteOff (int noteNumber);
+
+    // update the energies of the voices, free the silent ones and steal voices if the callback load is too high
+    void updateVoices();
+
+    // calculate the active voices from startSample up to (not including) endSample
+    void renderVoices (AudioBuffer<float>& buffer, int startSample, int endSample);
+
+    //// Voice allocation ////
+
+    // Steal voices until a voice with extraPoints grid points fits within the voice count and the target load.
+    // Returns false without stealing anything if it can never fit. Also returns false if it still doesn't fit after stealing
+    // all but numVoicesToKeep voices; the voices that were stolen or ended on the way stay that way.
+    bool makeRoom (int extraPoints, int numVoicesToKeep);
+
+    // whether the number of voices that are not fading out would exceed maxVoices
+    bool exceedsVoiceCount (int extraVoices);
+
+    // whether the estimated callback load of all calculated voices (including the ones fading out) would exceed targetLoad
+    bool exceedsLoad (int extraPoints);
+
+    // estimated callback load when calculating strings with a total of numPoints grid points
+    double estimateLoad (int numPoints);
+
+    // let the voice with the lowest level fade out. Returns false if there is no voice to steal.
+    bool stealVoice (int numVoicesToKeep);
+
+    // stop the voice that has faded out the most right away. Returns false if no voice is fading out.
+    bool endFadingVoice();
+
+    // stop a voice and remove it from activeVoices
+    void removeVoice (int idx);
+
+    // set a voice and its string back to the initial state (this does not remove it from activeVoices)
+    void stopVoice (int idx);
+
+    // update the estimate of the fixed time and the time per grid point of the callback
+    void updateCostEstimate (double elapsed, int numSamples);
+
+    // one string and voice for every note from lowestNote onwards
+    std::vector<std::unique_ptr<SimpleString>> strings;
+    std::vector<Voice> voices;
+
+    // Per string: the gain that normalises the peak output of a strike at full velocity to 1,
+    // and the energy of the string right after that strike
+    std::vector<double> stringGains;
+    std::vector<double> referenceEnergies;
+
+    // indices of the voices that are calculated (preallocated so that starting a voice does not allocate)
+    std::vector<int> activeVoices;
+
+    int lowestNote = 28;
+    double fs = 0;
+
+    //// Voice allocation ////
+    int maxVoices = 16;
+    int maxStolenVoices = 4;
+
+    // maximum fraction of the time between callbacks that the voices are allowed to use
+    double targetLoad = 0.7;
+
+    // length of the fade-out (in samples) of a stolen voice
+    int fadeLength = 64;
+
+    // voices with a level below this (-70 dB) are freed
+    double silenceThreshold = 1e-7;
+
+    // frequency independent damping while a note is held and after it is released
+    double sigma0 = 2.0;
+    double dampedSigma0 = 50.0;
+
+    //// Callback cost estimate ////
+
+    /*  The time a callback takes is modelled as fixedTime + timePerPoint * pointsCalculated, where
+        pointsCalculated is the number of grid points times the number of samples that have been
+        calculated. Both are fitted to the measured callback times using least squares, where
+        measurements older than costTimeConstant (in s) are gradually forgotten. timePerPoint starts
+        at the value measured while calibrating the strings in prepareToPlay().
+     */
+    double fixedTime = 0;
+    double timePerPoint = 0;
+    double pointsCalculated = 0;
+    double costTimeConstant = 2.0;
+
+    // (decayed) sums for the least squares fit
+    double sumW = 0, sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+
+    // size of the current block
+    int blockSize = 512;
+
+    //// Excitation and output ////
+    double maxHammerVelocity = 4.0;
+    double strikeLoc = 0.125;
+    double outputLoc = 0.8;
+
+    // gain of a normalised voice, leaving headroom for maxVoices sounding at the same time
+    double voiceGain = 0.5 / sqrt (static_cast<double> (maxVoices));
+
+    MidiKeyboardState keyboardState;
+
+    std::atomic<int> numActiveVoices { 0 };
+    std::atomic<int> highestNote { -1 };
+    std::atomic<double> callbackLoad { 0 };
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleStringPluginAudioProcessor)
+};
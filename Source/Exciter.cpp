@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    Exciter.cpp
+    Created: 18 Oct 2026 10:12:41am
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Exciter.h"
+
+//==============================================================================
+Exciter::Exciter (int N, int width, double k) : N (N), k (k)
+{
+    // The distribution can not be wider than the points that are calculated (1 to N-1)
+    width = std::min (width, N - 1);
+    
+    // Precalculate the raised cosine distribution (normalised so that it sums to 1)
+    dist.resize (width, 0);
+    double sum = 0;
+    for (int l = 0; l < width; ++l)
+    {
+        dist[l] = 0.5 * (1 - cos (2.0 * MathConstants<double>::pi * l / (width - 1.0)));
+        sum += dist[l];
+    }
+
+    for (int l = 0; l < width; ++l)
+    {
+        dist[l] /= sum;
+        distSq += dist[l] * dist[l];
+    }
+}
+
+Exciter::~Exciter()
+{
+
+}
+
+void Exciter::setLocation (double Lratio)
+{
+    // Keep the entire distribution within the points that are calculated (1 to N-1) so that the precalculated distribution can be used as is
+    int width = static_cast<int> (dist.size());
+    start = static_cast<int> (floor ((N+1) * Lratio) - floor (width * 0.5));
+    start = jlimit (1, std::max (N - width, 1), start);
+}
+
+double Exciter::interpolate (double* uVec)
+{
+    double val = 0;
+    for (int l = 0; l < static_cast<int> (dist.size()); ++l)
+        val += dist[l] * uVec[l + start];
+    return val;
+}
+
+void Exciter::spread (double* uVec, double force)
+{
+    for (int l = 0; l < static_cast<int> (dist.size()); ++l)
+        uVec[l + start] += forceScaling * dist[l] * force;
+}
+
+//==============================================================================
+Hammer::Hammer (int N, int width, double k, double M, double K, double alpha) : Exciter (N, width, k),
+                                                                                M (M), K (K), alpha (alpha)
+{
+    // g = phi' / psi = gCoeff * eta^((alpha - 1) / 2)
+    gCoeff = sqrt (0.5 * K * (alpha + 1.0));
+    kSqOverM = k * k / M;
+}
+
+void Hammer::strike (std::vector<double*>& u, double Lratio, double velocity)
+{
+    setLocation (Lratio);
+
+    // Start the hammer right at the string, moving towards it with the given velocity
+    uH = interpolate (u[1]);
+    uHPrev = uH - velocity * k;
+    etaPrev = uHPrev - interpolate (u[2]);
+    psiPrev = 0;
+
+    active = true;
+}
+
+void Hammer::applyForce (std::vector<double*>& u)
+{
+    if (!active)
+        return;
+
+    // distance between the hammer and the string (positive if they are in contact)
+    double eta = uH - interpolate (u[1]);
+    double g = eta > 0 ? gCoeff * pow (eta, 0.5 * (alpha - 1.0)) : 0;
+
+    // u_H^{n+1} and eta^{n+1} without the collision force
+    double uHNext = 2.0 * uH - uHPrev;
+    double etaNext = uHNext - interpolate (u[0]);
+
+    // Collision force solved in closed form (no iterations needed)
+    double force = (g * psiPrev + 0.25 * g * g * (etaNext - etaPrev))
+                    / (1.0 + 0.25 * g * g * (kSqOverM + forceScaling * distSq));
+
+    spread (u[0], force);
+    uHNext -= kSqOverM * force;
+    etaNext -= (kSqOverM + forceScaling * distSq) * force;
+
+    psiPrev += 0.5 * g * (etaNext - etaPrev);
+
+    // update the hammer states
+    uHPrev = uH;
+    uH = uHNext;
+    etaPrev = eta;
+
+    // the hammer is done when it has bounced off the string
+    if (etaNext < 0 && uH < uHPrev)
+        active = false;
+}
+
+//==============================================================================
+Bow::Bow (int N, int width, double k, double a) : Exciter (N, width, k), a (a)
+{
+    sqrt2a = sqrt (2.0 * a);
+}
+
+void Bow::startBowing (double Lratio)
+{
+    setLocation (Lratio);
+    active = true;
+}
+
+void Bow::applyForce (std::vector<double*>& u)
+{
+    if (!active)
+        return;
+
+    double uIm1 = interpolate (u[2]);
+
+    // Explicit estimate of the relative velocity used to evaluate Phi (v) / v
+    double vRelEst = (interpolate (u[1]) - uIm1) / k - vB;
+    double beta = Fb * sqrt2a * exp (-a * vRelEst * vRelEst + 0.5);
+
+    // Relative velocity (centred) solved in closed form (no iterations needed)
+    double vRel = ((interpolate (u[0]) - uIm1) / (2.0 * k) - vB)
+                    / (1.0 + forceScaling * distSq * beta / (2.0 * k));
+
+    spread (u[0], -beta * vRel);
+}
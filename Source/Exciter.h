@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    Exciter.h
+    Created: 18 Oct 2026 10:12:41am
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Base class for excitations that are integrated into the time step of the string.
+
+    The force is applied at a location on the string through a (normalised) raised
+    cosine distribution that is precomputed when the exciter is created. The same
+    distribution is used to interpolate the state of the string at the exciter location,
+    which keeps the string-exciter connection energy-conserving.
+
+    Both exciters below are non-iterative: the force at every sample is solved in closed
+    form, so the cost per sample is fixed and only depends on the width of the distribution.
+*/
+class Exciter
+{
+public:
+    Exciter (int N, int width, double k);
+    virtual ~Exciter();
+
+    // set the location of the exciter as a ratio of the length of the string
+    void setLocation (double Lratio);
+
+    // Set the scaling from a force at the exciter location to a displacement of u^{n+1}.
+    // For the stiff string this is k^2 / (rho * A * h * (1 + sigma0 * k)).
+    void setForceScaling (double forceScalingToSet) { forceScaling = forceScalingToSet; };
+
+    // add the excitation to u^{n+1} (u[0]), which should already contain the update of the string itself
+    virtual void applyForce (std::vector<double*>& u) = 0;
+
+    bool isActive() { return active; };
+    void deactivate() { active = false; };
+
+protected:
+    // interpolate a state vector at the exciter location
+    double interpolate (double* uVec);
+
+    // spread a force over a state vector at the exciter location
+    void spread (double* uVec, double force);
+
+    int N;
+    double k;
+
+    // precomputed distribution and the sum of its squared values
+    std::vector<double> dist;
+    double distSq = 0;
+
+    // first grid point of the distribution
+    int start = 1;
+
+    double forceScaling = 0;
+
+    bool active = false;
+};
+
+//==============================================================================
+/*
+    Nonlinear hammer (lumped mass colliding with the string).
+
+    The collision potential phi = K / (alpha + 1) * [eta]_+^(alpha + 1) is quadratised
+    using psi = sqrt (2 * phi), which makes the update for the collision force linear.
+*/
+class Hammer : public Exciter
+{
+public:
+    Hammer (int N, int width, double k, double M, double K, double alpha);
+
+    // let the hammer hit the string at a location (as a ratio of the string length) with a given velocity (in m/s)
+    void strike (std::vector<double*>& u, double Lratio, double velocity);
+
+    void applyForce (std::vector<double*>& u) override;
+
+private:
+    // Hammer parameters (mass, collision stiffness and collision exponent)
+    double M, K, alpha;
+
+    // precalculated terms for the collision
+    double gCoeff, kSqOverM;
+
+    // state of the hammer (uH^n and uH^{n-1}), the distance between hammer and string at n-1, and psi^{n-1/2}
+    double uH = 0, uHPrev = 0, etaPrev = 0, psiPrev = 0;
+};
+
+//==============================================================================
+/*
+    Bow using the exponential friction characteristic Phi (v) = sqrt (2a) * v * exp (-a * v^2 + 1/2).
+
+    Rather than solving for the relative velocity using Newton-Raphson, the friction
+    characteristic is written as Phi (v) = (Phi (v) / v) * v, where Phi (v) / v >= 0 is
+    evaluated at an explicit estimate of the relative velocity. The update is then linear
+    in the relative velocity and the bow can only remove energy from the relative motion.
+*/
+class Bow : public Exciter
+{
+public:
+    Bow (int N, int width, double k, double a);
+
+    // start bowing at a location (as a ratio of the string length)
+    void startBowing (double Lratio);
+    void stopBowing() { active = false; };
+
+    void setBowForce (double FbToSet) { Fb = FbToSet; };
+    void setBowVelocity (double vBToSet) { vB = vBToSet; };
+
+    void applyForce (std::vector<double*>& u) override;
+
+private:
+    // free parameter of the friction characteristic and its precalculated sqrt (2a)
+    double a, sqrt2a;
+
+    // bow force (in N) and bow velocity (in m/s)
+    double Fb = 0, vB = 0.2;
+};
@@ -46,6 +46,19 @@ void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRat
     parameters.set ("sigma0", 2);
     parameters.set ("sigma1", 0.005);
     
+    // width (in m) of the area over which the hammer and bow act on the string
+    parameters.set ("excitationWidth", 0.08);
+    
+    // hammer parameters
+    parameters.set ("MH", 0.005);       // mass
+    parameters.set ("KH", 1e8);         // collision stiffness
+    parameters.set ("alphaH", 2.5);     // collision exponent
+    parameters.set ("vH", 2.0);         // strike velocity
+    
+    // bow parameters
+    parameters.set ("a", 100);          // free parameter of the friction characteristic
+    parameters.set ("maxFb", 5.0);      // maximum bow force
+    
     //// Initialise an instance of the SimpleString class ////
     mySimpleString = std::make_unique<SimpleString> (parameters, 1.0 / sampleRate);
     
@@ -81,7 +94,8 @@ void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& buffe
         mySimpleString->calculateScheme();
         mySimpleString->updateStates();
         
-        output = mySimpleString->getOutput (0.8); // get output at 0.8L of the string
+        // get output at 0.8L of the string (the displacement is in the order of millimetres, so scale it up)
+        output = mySimpleString->getOutput (0.8) * outputGain;
         for (int channel = 0; channel < numChannels; ++channel)
             curChannel[channel][0][i] = limit(output);
     }
@@ -33,5 +33,7 @@ private:
     // Your private member variables go here...
     std::unique_ptr<SimpleString> mySimpleString;
     
+    double outputGain = 300.0;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
@@ -58,27 +58,23 @@ SimpleString::SimpleString (NamedValueSet& parameters, double k) : k (k)
     for (int i = 0; i < 3; ++i)
         u[i] = &uStates[i][0];
     
-    // Coefficients used for damping
-    S0 = sigma0 * k;
-    S1 = (2.0 * sigma1 * k) / (h * h);
+    //// Initialise the exciters ////
     
-    // Scheme coefficients
-    B0 = 2.0 - 2.0 * lambdaSq - 6.0 * muSq - 2.0 * S1; // u_l^n
-    Bss = 2.0 - 2.0 * lambdaSq - 5.0 * muSq - 2.0 * S1;
-    B1 = lambdaSq + 4.0 * muSq + S1;                   // u_{l+-1}^n
-    B2 = -muSq;                                        // u_{l+-2}^n
-    C0 = -1.0 + S0 + 2.0 * S1;                         // u_l^{n-1}
-    C1 = -S1;                                          // u_{l+-1}^{n-1}
+    // Width (in grid points) of the excitation distribution following from its width in m.
+    // A width of 3 points (with zeros at both ends) is the smallest that still excites the string.
+    int width = std::max (3, static_cast<int> (round (*parameters.getVarPointer ("excitationWidth") / h)) + 1);
     
-    Adiv = 1.0 / (1.0 + S0);                           // u_l^{n+1}
+    hammer = std::make_unique<Hammer> (N, width, k,
+                                       *parameters.getVarPointer ("MH"),
+                                       *parameters.getVarPointer ("KH"),
+                                       *parameters.getVarPointer ("alphaH"));
+    bow = std::make_unique<Bow> (N, width, k, *parameters.getVarPointer ("a"));
     
-    // Divide by u_l^{n+1} term
-    B0 *= Adiv;
-    Bss *= Adiv;
-    B1 *= Adiv;
-    B2 *= Adiv;
-    C0 *= Adiv;
-    C1 *= Adiv;
+    hammerVelocity = *parameters.getVarPointer ("vH");
+    maxBowForce = *parameters.getVarPointer ("maxFb");
+    
+    // Calculate the scheme coefficients (this also sets the force scaling of the exciters)
+    calculateCoefficients();
 }
 
 SimpleString::~SimpleString()
@@ -95,7 +91,7 @@ void SimpleString::paint (juce::Graphics& g)
     g.setColour(Colours::cyan);
     
     // draw the state
-    g.strokePath(visualiseState (g, 100), PathStrokeType(2.0f));
+    g.strokePath(visualiseState (g, 10000), PathStrokeType(2.0f));
 
 }
 
@@ -135,6 +131,36 @@ void SimpleString::resized()
 
 }
 
+void SimpleString::calculateCoefficients()
+{
+    // Coefficients used for damping
+    S0 = sigma0 * k;
+    S1 = (2.0 * sigma1 * k) / (h * h);
+    
+    // Scheme coefficients
+    B0 = 2.0 - 2.0 * lambdaSq - 6.0 * muSq - 2.0 * S1; // u_l^n
+    Bss = 2.0 - 2.0 * lambdaSq - 5.0 * muSq - 2.0 * S1;
+    B1 = lambdaSq + 4.0 * muSq + S1;                   // u_{l+-1}^n
+    B2 = -muSq;                                        // u_{l+-2}^n
+    C0 = -1.0 + S0 + 2.0 * S1;                         // u_l^{n-1}
+    C1 = -S1;                                          // u_{l+-1}^{n-1}
+    
+    Adiv = 1.0 / (1.0 + S0);                           // u_l^{n+1}
+    
+    // Divide by u_l^{n+1} term
+    B0 *= Adiv;
+    Bss *= Adiv;
+    B1 *= Adiv;
+    B2 *= Adiv;
+    C0 *= Adiv;
+    C1 *= Adiv;
+    
+    // Scaling of a force at the exciter location to a displacement of u^{n+1}
+    double forceScaling = Adiv * k * k / (rho * A * h);
+    hammer->setForceScaling (forceScaling);
+    bow->setForceScaling (forceScaling);
+}
+
 void SimpleString::calculateScheme()
 {
     for (int l = 2; l < N-1; ++l) // clamped boundaries
@@ -146,8 +172,9 @@ void SimpleString::calculateScheme()
     u[0][N-1] = Bss * u[1][N-1] + B1 * (u[1][N] + u[1][N-2]) + B2 * (u[1][N-3])
             + C0 * u[2][N-1] + C1 * (u[2][N] + u[2][N-2]);
 
-
-    
+    // Add the excitations to u^{n+1}. These are non-iterative so they have a fixed cost per sample.
+    hammer->applyForce (u);
+    bow->applyForce (u);
 }
 
 void SimpleString::updateStates()
@@ -161,32 +188,104 @@ void SimpleString::updateStates()
 
 void SimpleString::excite()
 {
-    //// Arbitrary excitation function (raised cosine) ////
-    
-    // width (in grid points) of the excitation
-    double width = 10;
-    
-    // make sure we're not going out of bounds at the left boundary
-    int start = std::max (floor((N+1) * excitationLoc) - floor(width * 0.5), 1.0);
-
-    for (int l = 0; l < width; ++l)
+    // Strike the string with the hammer (this resets the hammer if it is still in contact with the string)
+    if (strikeFlag)
     {
-        // make sure we're not going out of bounds at the right boundary (this does 'cut off' the raised cosine)
-        if (l+start > (clamped ? N - 2 : N - 1))
-            break;
-        
-        u[1][l+start] += 0.5 * (1 - cos(2.0 * double_Pi * l / (width-1.0)));
-        u[2][l+start] += 0.5 * (1 - cos(2.0 * double_Pi * l / (width-1.0)));
+        hammer->strike (u, excitationLoc, hammerVelocity);
+        strikeFlag = false;
     }
-    // Disable the excitation flag to only excite once
+    
+    // Start or stop bowing
+    if (bowFlag && !bow->isActive())
+        bow->startBowing (excitationLoc);
+    else if (!bowFlag && bow->isActive())
+        bow->stopBowing();
+    
+    bow->setBowForce (bowForce);
+    
+    // Disable the excitation flag to only handle the changes once
     excitationFlag = false;
 }
 
+void SimpleString::strike (double Lratio, double velocity)
+{
+    hammer->strike (u, Lratio, velocity);
+}
+
+void SimpleString::setDamping (double sigma0ToSet)
+{
+    // Only sigma0 can be changed on the fly as it does not change the stability condition (and thus N)
+    sigma0 = sigma0ToSet;
+    calculateCoefficients();
+}
+
+double SimpleString::getEnergy()
+{
+    // Energy of the string only (the energy of the exciters is not included)
+    double kinEnergy = 0;
+    double potEnergy = 0;
+    double stiffEnergy = 0;
+    
+    for (int l = 0; l <= N; ++l)
+        kinEnergy += (u[1][l] - u[2][l]) * (u[1][l] - u[2][l]);
+    
+    for (int l = 0; l < N; ++l)
+        potEnergy += (u[1][l + 1] - u[1][l]) * (u[2][l + 1] - u[2][l]);
+    
+    for (int l = 1; l < N; ++l)
+        stiffEnergy += (u[1][l + 1] - 2.0 * u[1][l] + u[1][l - 1]) * (u[2][l + 1] - 2.0 * u[2][l] + u[2][l - 1]);
+    
+    return 0.5 * rho * A * h * kinEnergy / (k * k)
+         + 0.5 * T * potEnergy / h
+         + 0.5 * E * I * stiffEnergy / (h * h * h);
+}
+
+void SimpleString::reset()
+{
+    for (int i = 0; i < 3; ++i)
+        std::fill (uStates[i].begin(), uStates[i].end(), 0);
+    
+    hammer->deactivate();
+    bow->stopBowing();
+}
+
 void SimpleString::mouseDown (const MouseEvent& e)
 {
     // Get the excitation location as a ratio between the x-location of the mouse-click and the width of the app
     excitationLoc = e.x / static_cast<double> (getWidth());
     
+    // Bow the string when shift is held down, otherwise strike it with the hammer
+    if (e.mods.isShiftDown())
+    {
+        bowFlag = true;
+        mouseDrag (e);
+    }
+    else
+    {
+        strikeFlag = true;
+    }
+    
     // Activate the excitation flag to be used by the MainComponent to excite the string
     excitationFlag = true;
 }
+
+void SimpleString::mouseDrag (const MouseEvent& e)
+{
+    if (!bowFlag)
+        return;
+    
+    // The bow force depends on the vertical location of the mouse (higher is more force)
+    bowForce = maxBowForce * jlimit (0.0, 1.0, 1.0 - e.y / static_cast<double> (getHeight()));
+    excitationFlag = true;
+}
+
+void SimpleString::mouseUp (const MouseEvent& e)
+{
+    ignoreUnused (e);
+    
+    if (!bowFlag)
+        return;
+    
+    bowFlag = false;
+    excitationFlag = true;
+}
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Exciter.h"
 
 //==============================================================================
 /*
@@ -27,6 +28,9 @@ public:
     // function to draw the state of the string
     Path visualiseState (Graphics& g, double visualScaling);
 
+    // (re)calculate the scheme coefficients
+    void calculateCoefficients();
+    
     void calculateScheme();
     void updateStates();
     
@@ -37,11 +41,31 @@ public:
         return u[1][static_cast<int> (round(N * Lratio))];
     }
     
+    // handle excitation changes (hammer strikes and bowing) coming from the mouse
     void excite();
     void mouseDown (const MouseEvent& e) override;
+    void mouseDrag (const MouseEvent& e) override;
+    void mouseUp (const MouseEvent& e) override;
     
     bool shouldExcite() { return excitationFlag; };
     
+    // strike the string with the hammer right away (called from the audio thread, e.g. on a MIDI note)
+    void strike (double Lratio, double velocity);
+    
+    // whether the hammer or the bow is currently interacting with the string
+    bool isExcited() { return hammer->isActive() || bow->isActive(); };
+    
+    // change the frequency independent damping (used for damping the string on a note-off)
+    void setDamping (double sigma0ToSet);
+    
+    // total energy of the string at the current sample
+    double getEnergy();
+    
+    // set the string to rest
+    void reset();
+    
+    int getNumIntervals() { return N; };
+    
 private:
     
     // Model parameters
@@ -70,7 +94,16 @@ private:
     // initialise location of excitation
     double excitationLoc = 0.5;
     
-    bool clamped = true;
+    // Exciters (applied in calculateScheme())
+    std::unique_ptr<Hammer> hammer;
+    std::unique_ptr<Bow> bow;
+    
+    // excitation controls set by the mouse
+    bool strikeFlag = false;
+    bool bowFlag = false;
+    double hammerVelocity = 2.0;
+    double bowForce = 0;
+    double maxBowForce;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleString)
 };